@@ -0,0 +1,92 @@
+#include "graph_builder_class.hpp"
+// Scaling benchmark for graph_builder
+// Build:  g++ -O2 -std=c++20 -pthread bench_build.cpp -o bench_build
+// Usage:  ./bench_build [M = 100000000] [N = M / 10] [--serial]
+// Times the forward, reverse and condensation CSR builds from M random edges
+// for 1, 2, 4, ... threads (the calling thread counts as one of them).
+// --serial also times the set<> adjacency list used by main.cpp (needs far
+// more memory than the CSR path).
+
+double seconds_since(chrono::steady_clock::time_point t)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+int main(int argc, char *argv[])
+{
+    long long int M = 100000000, N = -1;
+    bool serial = false;
+    vector<long long int> nums;
+    for (int i = 1; i < argc; i++)
+    {
+        if (string(argv[i]) == "--serial")
+            serial = true;
+        else
+            nums.push_back(stoll(argv[i]));
+    }
+    if (nums.size() > 0)
+        M = nums[0];
+    N = nums.size() > 1 ? nums[1] : max(1LL, M / 10);
+
+    // Random edge list, generated in parallel with one generator per chunk
+    vector<long long int> from(M), to(M);
+    {
+        thread_pool pool;
+        pool.parallel_for(0, M, 1 << 20, [&](long long int b, long long int e)
+                          {
+            mt19937_64 rng(b);
+            for (long long int i = b; i < e; i++)
+            {
+                from[i] = rng() % N + 1;
+                to[i] = rng() % N + 1;
+            } });
+    }
+    // Synthetic components of 8 consecutive vertices for the condensation step
+    long long int k = (N + 7) / 8;
+    vector<long long int> comp(N + 1, 0);
+    for (long long int u = 1; u <= N; u++)
+        comp[u] = (u - 1) / 8 + 1;
+
+    cout << "N = " << N << ", M = " << M << "\n";
+
+    if (serial)
+    {
+        auto t = chrono::steady_clock::now();
+        vector<set<long long int>> adj_list(N + 1);
+        for (long long int i = 0; i < M; i++)
+            adj_list[from[i]].insert(to[i]);
+        cout << "serial set<> build: " << fixed << setprecision(3) << seconds_since(t) << " s\n";
+    }
+
+    long long int hw = max(1U, thread::hardware_concurrency());
+    cout << "threads  forward  reverse  condense  total  speedup\n";
+    double base = 0;
+    for (long long int threads = 1;; threads = min(threads * 2, hw))
+    {
+        thread_pool pool(threads);
+        graph_builder builder(pool);
+
+        auto t = chrono::steady_clock::now();
+        csr fwd = builder.build(N, from, to);
+        double t_fwd = seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        csr rev = builder.reverse(fwd);
+        double t_rev = seconds_since(t);
+
+        t = chrono::steady_clock::now();
+        csr dag = builder.condense(fwd, comp, k);
+        double t_dag = seconds_since(t);
+
+        double total = t_fwd + t_rev + t_dag;
+        if (threads == 1)
+            base = total;
+        cout << setw(7) << pool.size() << fixed << setprecision(3)
+             << setw(9) << t_fwd << setw(9) << t_rev << setw(10) << t_dag
+             << setw(7) << total << setw(8) << setprecision(2) << base / total << "x"
+             << "   (" << fwd.edges() << " / " << rev.edges() << " / " << dag.edges() << " edges)\n";
+        if (threads == hw)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include "thread_pool_class.hpp"
+
+// Graph stored in compressed sparse row form.
+// The neighbours of vertex u are adj[offset[u]] .. adj[offset[u + 1] - 1],
+// sorted ascending and without duplicates (same order a set<> would give).
+class csr
+{
+public:
+    long long int n = 0;           // Vertices are 1..n, row 0 stays empty
+    vector<long long int> offset;  // Row start positions, size n + 2
+    vector<long long int> adj;     // Concatenated neighbour lists
+
+    long long int begin(long long int u) const
+    {
+        return offset[u];
+    }
+    long long int end(long long int u) const
+    {
+        return offset[u + 1];
+    }
+    long long int edges() const
+    {
+        return adj.size();
+    }
+};
+
+// Edges fed one at a time while the input is still being parsed (pipeline mode):
+// out-degrees are counted and edges are grouped by blocks of source vertices,
+// so graph_builder::build(edge_stream &) only has to lay the buckets out
+class edge_stream
+{
+public:
+    long long int n;
+    long long int block;                 // Source vertices per bucket
+    vector<long long int> deg;           // Out-degree per vertex, duplicates included
+    vector<vector<long long int>> buckets; // Flat (u, v) pairs, bucket u / block
+
+    edge_stream(long long int n1, long long int nbuckets = 1024) : n(n1)
+    {
+        block = max(1LL, (n + 1 + nbuckets - 1) / nbuckets);
+        deg.assign(n + 2, 0);
+        buckets.resize((n + 1 + block - 1) / block);
+    }
+
+    // Edges with u == 0 are skipped (same as graph_builder::build)
+    void add(long long int u, long long int v)
+    {
+        if (u == 0)
+            return;
+        deg[u]++;
+        buckets[u / block].push_back(u);
+        buckets[u / block].push_back(v);
+    }
+};
+
+// Builds forward, reverse and condensation CSRs in parallel on a thread_pool.
+// Rows are filled with a parallel counting sort (atomic degree count, prefix sum,
+// atomic scatter) and then sorted and deduplicated row by row; the reverse and
+// condensation graphs are counted and scattered from the rows of the forward CSR.
+class graph_builder
+{
+public:
+    thread_pool &pool;
+    long long int grain = 1 << 16; // Items per parallel_for chunk
+
+    graph_builder(thread_pool &p) : pool(p) {}
+
+    // In-place exclusive prefix sum, a[i] becomes a[0] + ... + a[i - 1]
+    void prefix_sum(vector<long long int> &a)
+    {
+        long long int n = a.size();
+        long long int chunks = (n + grain - 1) / grain;
+        vector<long long int> sums(chunks + 1, 0);
+        pool.parallel_for(0, chunks, 1, [&](long long int cb, long long int ce)
+                          {
+            for (long long int c = cb; c < ce; c++)
+            {
+                long long int s = 0;
+                for (long long int i = c * grain; i < min(n, (c + 1) * grain); i++)
+                    s += a[i];
+                sums[c + 1] = s;
+            } });
+        for (long long int c = 0; c < chunks; c++)
+            sums[c + 1] += sums[c];
+        pool.parallel_for(0, chunks, 1, [&](long long int cb, long long int ce)
+                          {
+            for (long long int c = cb; c < ce; c++)
+            {
+                long long int s = sums[c];
+                for (long long int i = c * grain; i < min(n, (c + 1) * grain); i++)
+                {
+                    long long int x = a[i];
+                    a[i] = s;
+                    s += x;
+                }
+            } });
+    }
+
+    // Build a CSR over vertices 1..n from the edge arrays from[i] -> to[i].
+    // Edges with from[i] == 0 are skipped, duplicate edges are merged.
+    csr build(long long int n, const vector<long long int> &from, const vector<long long int> &to)
+    {
+        long long int m = from.size();
+
+        // Step 1: Count out-degrees
+        vector<long long int> cursor(n + 2, 0);
+        pool.parallel_for(0, m, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int i = b; i < e; i++)
+                if (from[i] != 0)
+                    atomic_ref<long long int>(cursor[from[i]]).fetch_add(1, memory_order_relaxed); });
+
+        // Step 2: Prefix sum gives the row starts, scatter edges into their rows
+        prefix_sum(cursor);
+        vector<long long int> start = cursor;
+        vector<long long int> adj(start[n + 1]);
+        pool.parallel_for(0, m, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int i = b; i < e; i++)
+                if (from[i] != 0)
+                    adj[atomic_ref<long long int>(cursor[from[i]]).fetch_add(1, memory_order_relaxed)] = to[i]; });
+
+        return compact(n, start, adj);
+    }
+
+    // Sort and deduplicate the rows adj[start[u]] .. adj[start[u + 1] - 1]
+    // and pack them into the final CSR
+    csr compact(long long int n, const vector<long long int> &start, vector<long long int> &adj)
+    {
+        csr res;
+        res.n = n;
+
+        // Step 3: Sort and deduplicate each row, remember the new degree
+        vector<long long int> deg(n + 2, 0);
+        pool.parallel_for(1, n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int u = b; u < e; u++)
+            {
+                auto first = adj.begin() + start[u], last = adj.begin() + start[u + 1];
+                sort(first, last);
+                deg[u] = unique(first, last) - first;
+            } });
+
+        // Step 4: Compact the deduplicated rows into the final arrays
+        res.offset = deg;
+        prefix_sum(res.offset);
+        res.adj.resize(res.offset[n + 1]);
+        pool.parallel_for(1, n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int u = b; u < e; u++)
+                copy(adj.begin() + start[u], adj.begin() + start[u] + deg[u], res.adj.begin() + res.offset[u]); });
+        return res;
+    }
+
+    // Build a CSR from an edge_stream; its edges are already grouped by source
+    // block, so every bucket is scattered into its own rows without atomics
+    csr build(edge_stream &es)
+    {
+        long long int n = es.n;
+        vector<long long int> start = es.deg;
+        prefix_sum(start);
+        vector<long long int> adj(start[n + 1]);
+        pool.parallel_for(0, es.buckets.size(), 1, [&](long long int b, long long int e)
+                          {
+            for (long long int k = b; k < e; k++)
+            {
+                vector<long long int> &bucket = es.buckets[k];
+                vector<long long int> cursor(start.begin() + k * es.block, start.begin() + min(n + 1, (k + 1) * es.block));
+                for (long long int i = 0; i < (long long int)bucket.size(); i += 2)
+                    adj[cursor[bucket[i] - k * es.block]++] = bucket[i + 1];
+                vector<long long int>().swap(bucket);
+            } });
+        return compact(n, start, adj);
+    }
+
+    // Transposed graph: u -> v becomes v -> u. Counted and scattered straight
+    // from the rows of fwd; those hold no duplicates, so rows only need sorting
+    csr reverse(const csr &fwd)
+    {
+        long long int n = fwd.n;
+        csr res;
+        res.n = n;
+
+        // Step 1: Count in-degrees
+        vector<long long int> cursor(n + 2, 0);
+        pool.parallel_for(0, fwd.edges(), grain, [&](long long int b, long long int e)
+                          {
+            for (long long int j = b; j < e; j++)
+                atomic_ref<long long int>(cursor[fwd.adj[j]]).fetch_add(1, memory_order_relaxed); });
+
+        // Step 2: Prefix sum gives the row starts, scatter u into the row of each v
+        prefix_sum(cursor);
+        res.offset = cursor;
+        res.adj.resize(res.offset[n + 1]);
+        pool.parallel_for(1, n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int u = b; u < e; u++)
+                for (long long int j = fwd.begin(u); j < fwd.end(u); j++)
+                    res.adj[atomic_ref<long long int>(cursor[fwd.adj[j]]).fetch_add(1, memory_order_relaxed)] = u; });
+
+        // Step 3: Sort each row (chunks scatter in any order)
+        pool.parallel_for(1, n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int v = b; v < e; v++)
+                sort(res.adj.begin() + res.begin(v), res.adj.begin() + res.end(v)); });
+        return res;
+    }
+
+    // Condensation graph: vertex u is mapped to comp[u] (1..k),
+    // edges inside a component are dropped and parallel edges merged.
+    // Component degrees are counted and scattered straight from the rows of fwd.
+    csr condense(const csr &fwd, const vector<long long int> &comp, long long int k)
+    {
+        // Step 1: Count the edges leaving each component
+        vector<long long int> cursor(k + 2, 0);
+        pool.parallel_for(1, fwd.n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int u = b; u < e; u++)
+                for (long long int j = fwd.begin(u); j < fwd.end(u); j++)
+                    if (comp[u] != comp[fwd.adj[j]])
+                        atomic_ref<long long int>(cursor[comp[u]]).fetch_add(1, memory_order_relaxed); });
+
+        // Step 2: Prefix sum gives the row starts, scatter comp[v] into the row of comp[u]
+        prefix_sum(cursor);
+        vector<long long int> start = cursor;
+        vector<long long int> adj(start[k + 1]);
+        pool.parallel_for(1, fwd.n + 1, grain, [&](long long int b, long long int e)
+                          {
+            for (long long int u = b; u < e; u++)
+                for (long long int j = fwd.begin(u); j < fwd.end(u); j++)
+                {
+                    long long int v = fwd.adj[j];
+                    if (comp[u] != comp[v])
+                        adj[atomic_ref<long long int>(cursor[comp[u]]).fetch_add(1, memory_order_relaxed)] = comp[v];
+                } });
+
+        return compact(k, start, adj);
+    }
+};
@@ -1,4 +1,5 @@
 #include"event_class.hpp"
+#include"graph_builder_class.hpp"
 
 // Graph class to store graph data and perform computations
 class graph
@@ -13,7 +14,25 @@ public:
     long long int maxScore;              // Max hype score for Query 4
     long long int cycle = -1;            // Cycle detection flag
 
-    void call(); // Function to trigger preprocessing
+    vector<long long int> edge_from;     // Raw edge list, used by call_parallel() unless adj_csr is set
+    vector<long long int> edge_to;
+    csr adj_csr;                         // Original graph as CSR (parallel engine)
+    atomic<long long int> stage{0};      // Last step of call_parallel() that has finished
+
+    void publish(long long int step)     // Mark step as done and wake waiting readers
+    {
+        stage.store(step);
+        stage.notify_all();
+    }
+    void wait_for(long long int step)    // Block until publish(step) (or later) happened
+    {
+        long long int s;
+        while ((s = stage.load()) < step)
+            stage.wait(s);
+    }
+
+    void call();          // Function to trigger preprocessing
+    void call_parallel(); // Same preprocessing on CSR graphs built in parallel
 };
 
 graph g;
@@ -24,6 +43,9 @@ void dfsvisit(event &node, vector<set<long long int>> &adj_list, vector<event> &
 void dfs_scc(event &node, vector<event> &topsort, vector<set<long long int>> &adj_listt, vector<vector<long long int>> &sccs);
 void dfsvisit_scc(event &node, vector<set<long long int>> &adj_listt, vector<long long int> &v, vector<char> &colors);
 vector<event> findtopsort(vector<event> events1, vector<set<long long int>> adj_list1);
+void dfs_csr(csr &adj, vector<event> &events, long long int &p);
+void dfs_scc_csr(vector<event> &topsort, csr &adjt, vector<vector<long long int>> &sccs);
+vector<event> findtopsort_csr(vector<event> &events1, csr &adj1);
 
 // Perform topological sort using in-degree (Kahn's algorithm)
 vector<event> findtopsort(vector<event> events1, vector<set<long long int>> adj_list1)
@@ -197,3 +219,195 @@ void graph::call()
     }
 }
 
+
+// Kahn's algorithm on a CSR graph, same order as findtopsort()
+vector<event> findtopsort_csr(vector<event> &events1, csr &adj1)
+{
+    vector<long long int> indeg(events1.size());
+    set<long long int> s;
+    vector<event> result;
+    for (long long int i = 1; i < (long long int)(events1.size()); i++)
+    {
+        indeg[i] = events1[i].indeg;
+        if (indeg[i] == 0)
+            s.insert(i);
+    }
+    while (!s.empty())
+    {
+        auto l = *s.begin();
+        result.push_back(events1[l]);
+        for (long long int k = adj1.begin(l); k < adj1.end(l); k++)
+        {
+            long long int neigh = adj1.adj[k];
+            indeg[neigh]--;
+            if (indeg[neigh] == 0)
+                s.insert(neigh);
+        }
+        s.erase(l);
+    }
+    return result;
+}
+
+// Iterative version of dfs()/dfsvisit() on a CSR graph, visits nodes in the same order
+void dfs_csr(csr &adj, vector<event> &events, long long int &p)
+{
+    long long int n = adj.n;
+    for (long long int i = 1; i <= n; i++)
+        events[i].color = 'w';
+    long long int time = 0;
+    vector<pair<long long int, long long int>> st; // (node, next position in its row)
+    for (long long int i = 1; i <= n; i++)
+    {
+        if (events[i].color != 'w')
+            continue;
+        time += 1;
+        events[i].d = time;
+        events[i].color = 'g';
+        st.push_back({i, adj.begin(i)});
+        while (!st.empty())
+        {
+            long long int u = st.back().first;
+            if (st.back().second < adj.end(u))
+            {
+                long long int v = adj.adj[st.back().second++];
+                if (events[v].color == 'w')
+                {
+                    time += 1;
+                    events[v].d = time;
+                    events[v].color = 'g';
+                    st.push_back({v, adj.begin(v)});
+                }
+                else if (events[v].color == 'g' && p == 0)
+                    g.cycle = 1;
+            }
+            else
+            {
+                time += 1;
+                events[u].f = time;
+                events[u].color = 'b';
+                if (p == 0)
+                    g.topsort.push_back(events[u]);
+                else
+                    g.topsort_scc.push_back(events[u]);
+                st.pop_back();
+            }
+        }
+    }
+}
+
+// Iterative version of dfs_scc()/dfsvisit_scc() on the reversed CSR graph
+void dfs_scc_csr(vector<event> &topsort, csr &adjt, vector<vector<long long int>> &sccs)
+{
+    vector<char> colors(adjt.n + 1, 'w');
+    vector<pair<long long int, long long int>> st;
+    for (auto &node : topsort)
+    {
+        if (colors[node.index] != 'w')
+            continue;
+        vector<long long int> scc;
+        colors[node.index] = 'g';
+        scc.push_back(node.index);
+        st.push_back({node.index, adjt.begin(node.index)});
+        while (!st.empty())
+        {
+            long long int u = st.back().first;
+            if (st.back().second < adjt.end(u))
+            {
+                long long int v = adjt.adj[st.back().second++];
+                if (colors[v] == 'w')
+                {
+                    colors[v] = 'g';
+                    scc.push_back(v);
+                    st.push_back({v, adjt.begin(v)});
+                }
+            }
+            else
+            {
+                colors[u] = 'b';
+                st.pop_back();
+            }
+        }
+        sccs.push_back(scc);
+    }
+}
+
+// Same preprocessing as call(), but the forward, reverse and SCC graphs are
+// CSRs built in parallel from the raw edge list (edge_from / edge_to)
+void graph::call_parallel()
+{
+    long long int p = 0;
+    long long int n = events.size() - 1;
+    thread_pool pool;
+    graph_builder builder(pool);
+
+    // Step 0: Build the original graph from the edge list (the pipeline
+    // lays adj_csr out while parsing and skips this)
+    if (adj_csr.offset.empty())
+        adj_csr = builder.build(n, edge_from, edge_to);
+    vector<long long int>().swap(edge_from); // The edge list is not needed any more
+    vector<long long int>().swap(edge_to);
+
+    // Step 1: DFS to get finish times and detect cycles
+    dfs_csr(adj_csr, events, p);
+    reverse(topsort.begin(), topsort.end());
+    publish(1);
+
+    // Step 2: Kahn's algorithm for topological sort (used in Query 3)
+    topsort1 = findtopsort_csr(events, adj_csr);
+    publish(2);
+
+    // Step 3: Reverse the graph for SCCs
+    csr adj_csrt = builder.reverse(adj_csr);
+
+    // Step 4: Get SCCs using reversed graph and DFS
+    dfs_scc_csr(topsort, adj_csrt, sccs);
+    vector<long long int> comp(n + 1, 0);
+    pool.parallel_for(0, sccs.size(), builder.grain / 16, [&](long long int b, long long int e)
+                      {
+        for (long long int i = b; i < e; i++)
+            for (auto &j : sccs[i])
+            {
+                events[j].scc_index = i + 1;
+                comp[j] = i + 1;
+            } });
+    publish(4);
+
+    // Step 5: Build graph of SCCs
+    csr adj_csr_scc = builder.condense(adj_csr, comp, sccs.size());
+
+    // Step 6: Create new SCC vertices and assign cumulative hype scores
+    vector<event> scc_vertices(sccs.size() + 1);
+    pool.parallel_for(1, scc_vertices.size(), builder.grain / 16, [&](long long int b, long long int e)
+                      {
+        for (long long int i = b; i < e; i++)
+        {
+            scc_vertices[i].index = i;
+            scc_vertices[i].color = 'w';
+            scc_vertices[i].hype_score = 0;
+            for (auto &j : sccs[i - 1])
+                scc_vertices[i].hype_score += events[j].hype_score;
+        } });
+
+    // Step 7: DFS on SCC graph to compute max hype scores
+    p = 1;
+    dfs_csr(adj_csr_scc, scc_vertices, p);
+    reverse(topsort_scc.begin(), topsort_scc.end());
+
+    vector<long long> dp(scc_vertices.size(), 0);
+    for (long long int i = 1; i < scc_vertices.size(); i++)
+    {
+        dp[i] = scc_vertices[i].hype_score;
+    }
+
+    for (auto &e : topsort_scc)
+    {
+        long long int j = e.index;
+        for (long long int k = adj_csr_scc.begin(j); k < adj_csr_scc.end(j); k++)
+        {
+            long long int v = adj_csr_scc.adj[k];
+            dp[v] = max(dp[v], dp[j] + scc_vertices[v].hype_score);
+        }
+        maxScore = max(maxScore, dp[j]);
+    }
+    publish(7);
+}
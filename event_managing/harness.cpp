@@ -0,0 +1,353 @@
+#include <bits/stdc++.h>
+using namespace std;
+namespace fs = std::filesystem;
+// Differential correctness and performance regression harness
+// Build:  g++ -O2 -std=c++20 -pthread main.cpp -o main
+//         g++ -O2 -std=c++20 harness.cpp -o harness
+// Usage:  ./harness [--bin ./main] [--tests TestCases] [--engine NAME]... [--random K] [--seed S]
+//                   [--repeat R] [--baseline FILE] [--write-baseline] [--max-slowdown X] [--min-ms T]
+//                   [--timeout SEC]
+//
+// Every selected engine is run on all TestCases (compared with Expected Output) and on
+// K random graphs (compared with the reference engine, the first row of engines); every
+// fourth random graph has 10^5 vertices and 5 * 10^5 edges so its timings are reliable.
+// Stage timings come from ./main --timings; the best of R runs is kept, but each of the
+// R runs is checked. A run fails on an output mismatch in any repeat, a crash, a run
+// longer than SEC seconds, or a total time above X times the stored baseline (baselines
+// under T ms are too noisy and are not checked). The baseline is only written when
+// every run passed.
+
+// An engine is a way of running ./main, new engines only need a row here
+class engine
+{
+public:
+    string name;
+    string flags;
+};
+
+vector<engine> engines = {
+    {"serial", ""}, // Reference: graph::call() on set<> adjacency lists
+    {"parallel", "--parallel"},
+    {"pipeline", "--pipeline"},
+};
+
+vector<string> stage_names = {"read", "preprocess", "answer", "total"};
+long long int time_limit = 60; // Seconds per run of ./main (--timeout)
+
+class test_case
+{
+public:
+    string name;     // Key used in the baseline file
+    string input;    // Path of the input file
+    string expected; // Expected output text
+};
+
+class run_result
+{
+public:
+    bool crashed = false;
+    bool timed_out = false;
+    string output;
+    string mismatch; // First difference from the expected output over all runs
+    map<string, double> stages;
+};
+
+string read_file(const string &path)
+{
+    ifstream f(path, ios::binary);
+    stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+// Output lines without '\r', trailing spaces and trailing empty lines
+vector<string> normalize(const string &text)
+{
+    vector<string> lines;
+    stringstream ss(text);
+    string line;
+    while (getline(ss, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        lines.push_back(line);
+    }
+    while (!lines.empty() && lines.back().empty())
+        lines.pop_back();
+    return lines;
+}
+
+// Empty string if equal, otherwise a description of the first difference
+string compare(const string &got, const string &expected)
+{
+    vector<string> a = normalize(got), b = normalize(expected);
+    for (size_t i = 0; i < max(a.size(), b.size()); i++)
+    {
+        string x = i < a.size() ? a[i] : "<missing>";
+        string y = i < b.size() ? b[i] : "<missing>";
+        if (x != y)
+            return "line " + to_string(i + 1) + ": got \"" + x.substr(0, 60) + "\", expected \"" + y.substr(0, 60) + "\"";
+    }
+    return "";
+}
+
+run_result run_once(const string &bin, const engine &e, const string &input, const fs::path &tmp)
+{
+    fs::path out = tmp / "out.txt", err = tmp / "err.txt";
+    // The serial engine recurses once per DFS level, large graphs need a big stack
+    string cmd = "ulimit -s unlimited 2>/dev/null; timeout " + to_string(time_limit) + " \"" + bin + "\" " + e.flags +
+                 " --timings < \"" + input + "\" > \"" + out.string() + "\" 2> \"" + err.string() + "\"";
+    run_result r;
+    int status = system(cmd.c_str());
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    r.timed_out = code == 124; // Exit status of timeout(1) when the limit is hit
+    r.crashed = code != 0;
+    r.output = read_file(out.string());
+    stringstream ss(read_file(err.string()));
+    string word, name;
+    double ms;
+    while (ss >> word)
+    {
+        if (word == "stage" && ss >> name >> ms)
+            r.stages[name] = ms;
+    }
+    return r;
+}
+
+// Best of `repeat` runs (per stage). Every run is compared with expected, a crash,
+// timeout or mismatch in any of them fails the whole result
+run_result run(const string &bin, const engine &e, const string &input, const string &expected,
+               const fs::path &tmp, long long int repeat)
+{
+    run_result best;
+    for (long long int i = 0; i < repeat; i++)
+    {
+        run_result r = run_once(bin, e, input, tmp);
+        for (auto &s : r.stages)
+        {
+            if (best.stages.count(s.first) == 0 || s.second < best.stages[s.first])
+                best.stages[s.first] = s.second;
+        }
+        if (!r.crashed && best.mismatch.empty())
+        {
+            best.output = r.output;
+            best.mismatch = compare(r.output, expected);
+            if (!best.mismatch.empty() && repeat > 1)
+                best.mismatch = "run " + to_string(i + 1) + " of " + to_string(repeat) + ", " + best.mismatch;
+        }
+        best.crashed = best.crashed || r.crashed;
+        best.timed_out = best.timed_out || r.timed_out;
+    }
+    return best;
+}
+
+// Random input: small graphs with self-loops and duplicate edges, DAGs, larger sparse
+// graphs, and (kind 3) graphs big enough to time. n and m return the graph size.
+string random_input(mt19937_64 &rng, long long int kind, long long int &n, long long int &m)
+{
+    auto rnd = [&](long long int lo, long long int hi)
+    { return (long long int)(rng() % (hi - lo + 1)) + lo; };
+    n = kind == 3 ? 100000 : kind == 2 ? rnd(200, 2000) : rnd(1, 40);
+    m = kind == 3 ? 5 * n : kind == 2 ? rnd(n, 3 * n) : rnd(0, 3 * n);
+    vector<pair<long long int, long long int>> edges;
+    for (long long int i = 0; i < m; i++)
+    {
+        long long int u = rnd(1, n), v = rnd(1, n);
+        if (kind == 1 && u > v) // DAG: edges only go to larger indices
+            swap(u, v);
+        if (kind != 1 || u != v)
+            edges.push_back({u, v});
+    }
+    m = edges.size();
+    stringstream ss;
+    ss << n << " " << m << "\n";
+    for (long long int i = 1; i <= n; i++)
+        ss << rnd(0, 100) << (i == n ? "\n" : " ");
+    for (auto &e : edges)
+        ss << e.first << " " << e.second << "\n";
+    long long int q = rnd(4, 10);
+    ss << q << "\n";
+    for (long long int i = 0; i < q; i++)
+        ss << rnd(1, 4) << "\n";
+    return ss.str();
+}
+
+int main(int argc, char *argv[])
+{
+    string bin = "./main", tests = "TestCases", baseline_path = "";
+    vector<string> selected;
+    long long int random_cases = 20, seed = 1, repeat = 1;
+    double max_slowdown = 1.5, min_ms = 5;
+    bool write_baseline = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string a = argv[i];
+        string v = i + 1 < argc ? argv[i + 1] : "";
+        if (a == "--write-baseline")
+            write_baseline = true;
+        else if (i + 1 == argc)
+        {
+            cerr << "missing value for " << a << "\n";
+            return 2;
+        }
+        else if (a == "--bin")
+            bin = v, i++;
+        else if (a == "--tests")
+            tests = v, i++;
+        else if (a == "--engine")
+            selected.push_back(v), i++;
+        else if (a == "--random")
+            random_cases = stoll(v), i++;
+        else if (a == "--seed")
+            seed = stoll(v), i++;
+        else if (a == "--repeat")
+            repeat = max(1LL, stoll(v)), i++;
+        else if (a == "--baseline")
+            baseline_path = v, i++;
+        else if (a == "--max-slowdown")
+            max_slowdown = stod(v), i++;
+        else if (a == "--min-ms")
+            min_ms = stod(v), i++;
+        else if (a == "--timeout")
+            time_limit = stoll(v), i++;
+        else
+        {
+            cerr << "unknown option " << a << "\n";
+            return 2;
+        }
+    }
+    if (baseline_path.empty())
+        baseline_path = (fs::path(tests) / "baseline.txt").string();
+
+    vector<engine> run_engines;
+    for (auto &e : engines)
+    {
+        if (selected.empty() || find(selected.begin(), selected.end(), e.name) != selected.end())
+            run_engines.push_back(e);
+    }
+    for (auto &s : selected)
+    {
+        if (find_if(engines.begin(), engines.end(), [&](engine &e)
+                    { return e.name == s; }) == engines.end())
+        {
+            cerr << "unknown engine " << s << "\n";
+            return 2;
+        }
+    }
+
+    // Step 1: TestCases with their expected outputs, ordered by number
+    vector<pair<long long int, test_case>> numbered;
+    for (auto &f : fs::directory_iterator(fs::path(tests) / "Input"))
+    {
+        string name = f.path().filename().string(), digits;
+        for (char c : name)
+        {
+            if (isdigit(c))
+                digits += c;
+        }
+        fs::path expected = fs::path(tests) / "Expected Output" / ("Expected Output " + digits + ".txt");
+        if (digits.empty() || !fs::exists(expected))
+            continue;
+        numbered.push_back({stoll(digits), {"input-" + digits, f.path().string(), read_file(expected.string())}});
+    }
+    sort(numbered.begin(), numbered.end(), [](auto &a, auto &b)
+         { return a.first < b.first; });
+    vector<test_case> cases;
+    for (auto &c : numbered)
+        cases.push_back(c.second);
+
+    // Step 2: Random graphs, the expected output comes from the reference engine.
+    // The name (and baseline key) holds the seed and size, so other seeds never
+    // get compared with these timings
+    // Inputs and outputs live in tmp, which is removed on every return from here on
+    fs::path tmp = fs::temp_directory_path() / ("event_harness_" + to_string(getpid()));
+    fs::create_directories(tmp);
+    mt19937_64 rng(seed);
+    for (long long int i = 0; i < random_cases; i++)
+    {
+        long long int n, m;
+        string text = random_input(rng, i % 4, n, m);
+        string name = "random-" + to_string(i) + "-s" + to_string(seed) + "-n" + to_string(n) + "-m" + to_string(m);
+        fs::path input = tmp / (name + ".txt");
+        ofstream(input) << text;
+        run_result ref = run_once(bin, engines[0], input.string(), tmp);
+        if (ref.crashed)
+        {
+            cerr << "reference engine " << (ref.timed_out ? "timed out" : "crashed") << " on " << name << "\n";
+            fs::remove_all(tmp);
+            return 1;
+        }
+        cases.push_back({name, input.string(), ref.output});
+    }
+
+    // Step 3: Stored baseline, "engine case stage ms" per line
+    map<string, double> baseline;
+    {
+        ifstream f(baseline_path);
+        string e, c, s;
+        double ms;
+        while (f >> e >> c >> s >> ms)
+            baseline[e + " " + c + " " + s] = ms;
+    }
+    if (!write_baseline && baseline.empty())
+        cout << "no baseline at " << baseline_path << ", timings are not checked\n";
+
+    // Step 4: Run every engine on every case
+    long long int failures = 0;
+    vector<string> new_baseline;
+    cout << left << setw(30) << "case" << setw(10) << "engine" << setw(10) << "result";
+    for (auto &s : stage_names)
+        cout << right << setw(12) << s;
+    cout << "  (ms)\n";
+    for (auto &c : cases)
+    {
+        for (auto &e : run_engines)
+        {
+            run_result r = run(bin, e, c.input, c.expected, tmp, repeat);
+            string result = "OK", note = r.crashed ? "exited with an error" : r.mismatch;
+            if (r.timed_out)
+            {
+                result = "TIMEOUT";
+                note = "killed after " + to_string(time_limit) + " s";
+            }
+            else if (!note.empty())
+                result = "MISMATCH";
+            string key = e.name + " " + c.name + " ";
+            if (result == "OK" && !write_baseline && baseline.count(key + "total"))
+            {
+                double base = baseline[key + "total"];
+                if (base >= min_ms && r.stages["total"] > base * max_slowdown)
+                {
+                    result = "SLOW";
+                    note = "total " + to_string(r.stages["total"]) + " ms vs baseline " + to_string(base) + " ms";
+                }
+            }
+            if (result != "OK")
+                failures++;
+
+            cout << left << setw(30) << c.name << setw(10) << e.name << setw(10) << result << right << fixed << setprecision(3);
+            for (auto &s : stage_names)
+            {
+                cout << setw(12) << r.stages[s];
+                new_baseline.push_back(key + s + " " + to_string(r.stages[s]));
+            }
+            cout << "\n";
+            if (!note.empty())
+                cout << "    " << note << "\n";
+        }
+    }
+
+    if (write_baseline && failures > 0)
+        cout << "baseline not written: " << failures << " run(s) failed\n";
+    else if (write_baseline)
+    {
+        ofstream f(baseline_path);
+        for (auto &l : new_baseline)
+            f << l << "\n";
+        cout << "baseline written to " << baseline_path << "\n";
+    }
+    fs::remove_all(tmp);
+
+    cout << failures << " failure(s)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -1,9 +1,49 @@
-#include"graph_algo_class.hpp"
+#include"pipeline_class.hpp"
 // Driver code
-int main()
+// Usage: ./main [--parallel | --pipeline] [--timings]
+//   --parallel  builds CSR graphs on a thread pool
+//   --pipeline  also overlaps parsing, preprocessing and answering (see pipeline_class.hpp)
+//   --timings   prints stage timings to stderr (see timer_class.hpp)
+int main(int argc, char *argv[])
 {
+    bool parallel = false, pipelined = false, timings = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (string(argv[i]) == "--parallel")
+            parallel = true;
+        else if (string(argv[i]) == "--pipeline")
+            pipelined = true;
+        else if (string(argv[i]) == "--timings")
+            timings = true;
+    }
+
+    if (pipelined)
+    {
+        pipeline p;
+        p.run();
+        if (timings)
+            timer.report();
+        return 0;
+    }
+
+    // The parallel engine reads with the same buffered reader as the pipeline,
+    // the serial reference path keeps cin
+    reader in;
+    auto read = [&](long long int &x)
+    {
+        if (parallel)
+        {
+            if (!in.next(x))
+                x = 0; // Same as a failed cin >>
+        }
+        else
+            cin >> x;
+    };
+
+    auto t0 = timer.now();
     long long int N, M;
-    cin >> N >> M;
+    read(N);
+    read(M);
 
     // Create query handler objects
     GraphAlgorithm *q1 = new isCycle();
@@ -18,28 +58,49 @@ int main()
     {
         g.events[i].index = i;
         g.events[i].indeg = 0;
-        cin >> g.events[i].hype_score;
+        read(g.events[i].hype_score);
     }
 
     // Read edges
-    g.adj_list.resize(N + 1);
+    if (parallel)
+    {
+        g.edge_from.resize(M);
+        g.edge_to.resize(M);
+    }
+    else
+        g.adj_list.resize(N + 1);
     for (long long int i = 0; i < M; i++)
     {
         long long int u, v;
-        cin >> u >> v;
-        g.adj_list[u].insert(v);
+        read(u);
+        read(v);
+        if (parallel)
+        {
+            g.edge_from[i] = u;
+            g.edge_to[i] = v;
+        }
+        else
+            g.adj_list[u].insert(v);
         g.events[v].indeg++;
     }
 
+    timer.record("read", t0);
+
     // Precompute all graph data
-    g.call();
+    t0 = timer.now();
+    if (parallel)
+        g.call_parallel();
+    else
+        g.call();
+    timer.record("preprocess", t0);
 
+    t0 = timer.now();
     long long int Q;
-    cin >> Q;
+    read(Q);
     while (Q--)
     {
         long long int Q1;
-        cin >> Q1;
+        read(Q1);
         if (Q1 == 1)
             q1->Query();
         else if (Q1 == 2)
@@ -49,6 +110,9 @@ int main()
         else if (Q1 == 4)
             q4->Query();
     }
+    timer.record("answer", t0);
 
+    if (timings)
+        timer.report();
     return 0;
 }
\ No newline at end of file
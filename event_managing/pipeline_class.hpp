@@ -0,0 +1,121 @@
+#include"graph_algo_class.hpp"
+#include"spsc_queue_class.hpp"
+#include"timer_class.hpp"
+#include"reader_class.hpp"
+
+// Pipelined execution mode (./main --pipeline)
+// parser thread:  edges -> edge_q (batches) and then query types -> query_q
+// builder thread: edge_q -> edge_stream (degrees, source buckets), then the CSR
+//                 layout and g.call_parallel()
+// main thread:    answers query_q in input order, each one as soon as the
+//                 step of call_parallel() it depends on has been published
+class pipeline
+{
+public:
+    long long int batch = 4096;                  // Edges per edge_q item
+    spsc_queue<vector<long long int>> edge_q{64}; // Flat (u, v) pairs
+    spsc_queue<long long int> query_q{1 << 16};   // Query types, -1 ends the stream
+    reader in;
+
+    // Step of call_parallel() a query of type t has to wait for
+    long long int needs(long long int t)
+    {
+        if (t == 1)
+            return 1;
+        if (t == 2)
+            return 4;
+        if (t == 3)
+            return g.cycle == 1 ? 1 : 2; // "NO" is known right after the DFS
+        return 7;
+    }
+
+    void parse(long long int M)
+    {
+        auto t0 = timer.start; // Input is read from program start until here
+        vector<long long int> b;
+        for (long long int i = 0; i < M; i++)
+        {
+            long long int u = 0, v = 0;
+            in.next(u);
+            in.next(v);
+            b.push_back(u);
+            b.push_back(v);
+            if ((long long int)b.size() == 2 * batch)
+            {
+                edge_q.push(move(b));
+                b.clear();
+            }
+        }
+        edge_q.push(move(b));
+
+        long long int Q = 0, t;
+        in.next(Q);
+        while (Q-- && in.next(t))
+            query_q.push(t);
+        query_q.push(-1);
+        timer.record("read", t0);
+    }
+
+    // Degrees and source buckets are filled batch by batch while the parser
+    // is still running; only the final CSR layout waits for the last edge
+    void build(long long int N, long long int M)
+    {
+        edge_stream es(N);
+        long long int received = 0;
+        while (received < M)
+        {
+            vector<long long int> b = edge_q.pop();
+            if (b.empty())
+                break;
+            for (long long int i = 0; i < (long long int)b.size(); i += 2)
+            {
+                es.add(b[i], b[i + 1]);
+                g.events[b[i + 1]].indeg++;
+            }
+            received += b.size() / 2;
+        }
+        auto t0 = timer.now();
+        {
+            thread_pool pool;
+            graph_builder builder(pool);
+            g.adj_csr = builder.build(es);
+        }
+        g.call_parallel();
+        timer.record("preprocess", t0);
+    }
+
+    void run()
+    {
+        long long int N = 0, M = 0;
+        in.next(N);
+        in.next(M);
+        g.events.resize(N + 1);
+        for (long long int i = 1; i <= N; i++)
+        {
+            g.events[i].index = i;
+            g.events[i].indeg = 0;
+            in.next(g.events[i].hype_score);
+        }
+
+        thread parser([&]
+                      { parse(M); });
+        thread builder([&]
+                       { build(N, M); });
+
+        GraphAlgorithm *q[5] = {nullptr, new isCycle(), new indepComponent(), new validOrder(), new maxHype()};
+        long long int t;
+        auto t0 = timer.now();
+        while ((t = query_q.pop()) != -1)
+        {
+            if (t < 1 || t > 4)
+                continue;
+            g.wait_for(1);
+            g.wait_for(needs(t));
+            q[t]->Query();
+        }
+
+        timer.record("answer", t0);
+        parser.join();
+        builder.join();
+    }
+};
@@ -0,0 +1,44 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// Buffered integer reader over stdin (much faster than cin >> for large inputs)
+class reader
+{
+public:
+    vector<char> buf = vector<char>(1 << 16);
+    long long int len = 0, pos = 0;
+
+    int get()
+    {
+        if (pos == len)
+        {
+            len = fread(buf.data(), 1, buf.size(), stdin);
+            pos = 0;
+            if (len <= 0)
+                return -1;
+        }
+        return buf[pos++];
+    }
+
+    // Returns false at end of input
+    bool next(long long int &x)
+    {
+        int c = get();
+        while (c != -1 && c != '-' && (c < '0' || c > '9'))
+            c = get();
+        if (c == -1)
+            return false;
+        bool neg = c == '-';
+        if (neg)
+            c = get();
+        x = 0;
+        while (c >= '0' && c <= '9')
+        {
+            x = x * 10 + (c - '0');
+            c = get();
+        }
+        if (neg)
+            x = -x;
+        return true;
+    }
+};
@@ -0,0 +1,50 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// push() waits while the ring is full, pop() waits while it is empty
+// (a short spin, then a blocking atomic::wait woken by the other side).
+template <class T>
+class spsc_queue
+{
+    vector<T> ring;
+    long long int cap;
+    alignas(64) atomic<long long int> head{0}; // Next slot to pop (owned by consumer)
+    alignas(64) atomic<long long int> tail{0}; // Next slot to push (owned by producer)
+
+    // Wait until the other side moves its index away from `old`:
+    // spin for a short while, then sleep in atomic::wait
+    static void wait_while(atomic<long long int> &index, long long int old)
+    {
+        for (int i = 0; i < 64; i++)
+        {
+            if (index.load(memory_order_acquire) != old)
+                return;
+            this_thread::yield();
+        }
+        while (index.load(memory_order_acquire) == old)
+            index.wait(old, memory_order_acquire);
+    }
+
+public:
+    spsc_queue(long long int capacity) : ring(capacity), cap(capacity) {}
+
+    void push(T x)
+    {
+        long long int t = tail.load(memory_order_relaxed);
+        wait_while(head, t - cap);
+        ring[t % cap] = move(x);
+        tail.store(t + 1, memory_order_release);
+        tail.notify_one();
+    }
+
+    T pop()
+    {
+        long long int h = head.load(memory_order_relaxed);
+        wait_while(tail, h);
+        T x = move(ring[h % cap]);
+        head.store(h + 1, memory_order_release);
+        head.notify_one();
+        return x;
+    }
+};
@@ -0,0 +1,136 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// Work-stealing thread pool used by the parallel graph builder.
+// A pool of n threads is the thread calling parallel_for() plus n - 1 workers.
+// Each of them owns a deque of tasks (deque 0 is the caller's): it pops from the
+// back of its own deque and, when that is empty, steals from the front of the others.
+class thread_pool
+{
+    class worker
+    {
+    public:
+        deque<function<void()>> tasks;
+        mutex m;
+    };
+
+    vector<unique_ptr<worker>> workers;
+    vector<thread> threads;
+    mutex sleep_m;
+    condition_variable sleep_cv;
+    atomic<long long int> queued{0}; // Tasks pushed but not yet picked up
+    bool stop = false;
+
+    // Take one task: own deque first (LIFO), then steal from the others (FIFO)
+    bool take(long long int self, function<void()> &task)
+    {
+        long long int n = workers.size();
+        for (long long int k = 0; k < n; k++)
+        {
+            worker &w = *workers[(self + k) % n];
+            lock_guard<mutex> lock(w.m);
+            if (w.tasks.empty())
+                continue;
+            if (k == 0)
+            {
+                task = move(w.tasks.back());
+                w.tasks.pop_back();
+            }
+            else
+            {
+                task = move(w.tasks.front());
+                w.tasks.pop_front();
+            }
+            queued--;
+            return true;
+        }
+        return false;
+    }
+
+    void run(long long int self)
+    {
+        function<void()> task;
+        while (true)
+        {
+            if (take(self, task))
+            {
+                task();
+                continue;
+            }
+            unique_lock<mutex> lock(sleep_m);
+            sleep_cv.wait(lock, [&]
+                          { return stop || queued > 0; });
+            if (stop && queued == 0)
+                return;
+        }
+    }
+
+public:
+    thread_pool(long long int n = thread::hardware_concurrency())
+    {
+        n = max(n, 1LL);
+        for (long long int i = 0; i < n; i++)
+            workers.push_back(make_unique<worker>());
+        for (long long int i = 1; i < n; i++)
+            threads.emplace_back([this, i]
+                                 { run(i); });
+    }
+
+    ~thread_pool()
+    {
+        {
+            lock_guard<mutex> lock(sleep_m);
+            stop = true;
+        }
+        sleep_cv.notify_all();
+        for (auto &t : threads)
+            t.join();
+    }
+
+    // Number of threads, including the one calling parallel_for()
+    long long int size() const
+    {
+        return workers.size();
+    }
+
+    // Run fn(b, e) over [begin, end) split into chunks of at most grain items.
+    // The calling thread helps (and steals) until every chunk has finished.
+    template <class F>
+    void parallel_for(long long int begin, long long int end, long long int grain, F fn)
+    {
+        if (begin >= end)
+            return;
+        grain = max(grain, 1LL);
+        long long int chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1 || workers.size() == 1)
+        {
+            fn(begin, end);
+            return;
+        }
+
+        auto remaining = make_shared<atomic<long long int>>(chunks);
+        for (long long int c = 0; c < chunks; c++)
+        {
+            long long int b = begin + c * grain;
+            long long int e = min(end, b + grain);
+            worker &w = *workers[c % workers.size()];
+            lock_guard<mutex> lock(w.m);
+            w.tasks.push_back([&fn, b, e, remaining]
+                              { fn(b, e); (*remaining)--; });
+        }
+        {
+            lock_guard<mutex> lock(sleep_m);
+            queued += chunks;
+        }
+        sleep_cv.notify_all();
+
+        function<void()> task;
+        while (*remaining > 0)
+        {
+            if (take(0, task))
+                task();
+            else
+                this_thread::yield();
+        }
+    }
+};
@@ -0,0 +1,34 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// Wall-clock timings of the driver stages, printed by ./main --timings
+// as "stage <name> <milliseconds>" lines on stderr (read by harness.cpp)
+class stage_timer
+{
+public:
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<pair<string, double>> stages;
+    mutex m;
+
+    chrono::steady_clock::time_point now()
+    {
+        return chrono::steady_clock::now();
+    }
+
+    // Record a stage that began at t0 and ends now (callable from any thread)
+    void record(string name, chrono::steady_clock::time_point t0)
+    {
+        double ms = chrono::duration<double, milli>(now() - t0).count();
+        lock_guard<mutex> lock(m);
+        stages.push_back({name, ms});
+    }
+
+    void report()
+    {
+        record("total", start);
+        for (auto &s : stages)
+            cerr << "stage " << s.first << " " << fixed << setprecision(3) << s.second << "\n";
+    }
+};
+
+stage_timer timer;